@@ -0,0 +1,41 @@
+#include <iostream>
+#include <chrono>
+#include "compiler/compile.h"
+#include "core/token.h"
+#include "debug-api.h"
+
+//Lexes generated sources of increasing size and reports the lexer throughput.
+//Tokens per second should stay flat as the source grows
+static std::string generate_source(size_t lines) {
+    std::string source;
+    //Every function is five lines with 41 tokens
+    for(size_t idx = 0; idx < lines / 5; idx++) {
+        source += fmt::format("int count_{}(unsigned long long value, char* name) {{\n", idx);
+        source += fmt::format("    while(value != {} && name[0] == 'a')\n", idx);
+        source += "        value = (value << 1) + \"text\" - name;\n";
+        source += "    return value;\n}\n";
+    }
+
+    return source;
+}
+
+int app_start(int argc, char** argv) {
+#ifdef SIMDEBUG
+    //Debug logs would dominate the measurement
+    sim_logger->set_level(spdlog::level::warn);
+#endif
+    size_t max_lines = argc > 1 ? std::stoul(argv[1]) : 400000;
+    std::cout << "lines\ttokens\ttime(ms)\tMtokens/s\tMB/s" << std::endl;
+    for(size_t lines = max_lines / 8; lines <= max_lines; lines *= 2) {
+        auto source = generate_source(lines);
+        token::global_diag_inst.init("simcc-bench.c", 1, source);
+
+        auto start = std::chrono::steady_clock::now();
+        lex(source);
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << lines << '\t' << tokens.size() << '\t' << static_cast<size_t>(elapsed * 1000) << '\t'
+            << fmt::format("{:.1f}\t{:.1f}", tokens.size() / elapsed / 1e6, source.size() / elapsed / 1e6) << std::endl;
+    }
+
+    return 0;
+}
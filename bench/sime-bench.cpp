@@ -0,0 +1,41 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include "driver/pipeline.h"
+#include "common/file-utils.h"
+#include "debug-api.h"
+
+//Preprocesses generated files with an increasing number of macro invocations.
+//The time per invocation should stay flat as the file grows
+static std::string generate_source(size_t invocations) {
+    std::string source = "#define SQ(x) ((x)*(x))\n#define ADD(a, b) (SQ(a) + (b))\n#define ONE 1\n";
+    //Every line has three invocations
+    for(size_t idx = 0; idx < invocations / 3; idx++) {
+        source += fmt::format("int v{} = ADD(ONE, {}) + SQ(ONE);\n", idx, idx);
+    }
+
+    return source;
+}
+
+int app_start(int argc, char** argv) {
+#ifdef SIMDEBUG
+    //Debug logs would dominate the measurement
+    sim_logger->set_level(spdlog::level::warn);
+    init_preprocessor_debugger(sim_logger);
+#endif
+    size_t max_invocations = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::cout << "invocations\ttime(ms)\tns/invocation" << std::endl;
+    for(size_t invocations = max_invocations / 8; invocations <= max_invocations; invocations *= 2) {
+        //Files stay in the include cache for the whole process, so every size gets its own file
+        auto file_name = (std::filesystem::temp_directory_path() / fmt::format("sime-bench-{}.c", invocations)).string();
+        write_file(file_name, generate_source(invocations));
+
+        auto start = std::chrono::steady_clock::now();
+        auto output = preprocess_unit(file_name, {});
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << invocations << '\t' << elapsed / 1000000 << '\t' << elapsed / invocations << std::endl;
+        std::filesystem::remove(file_name);
+    }
+
+    return 0;
+}
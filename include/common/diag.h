@@ -1,16 +1,30 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstdint>
+
+//Thrown instead of printing a diagnostic on threads which suppress them
+struct diag_suppressed {};
 
 class diag {
-    std::string file_name;
+    std::string_view file_name;         //Must outlive the diag
     size_t start_line;   
-    std::vector<std::string> lines;
+    std::string_view contents;          //Must outlive the diag
+    std::vector<uint32_t> line_starts;  //Offsets of the lines of contents, found when the first error is printed
+    static thread_local bool is_suppressed;
     
-    void split_into_lines(const std::vector<char>& file_content);
 public:
-    
+    //For work which may be thrown away (ex: speculative preprocessing). Instead of printing anything,
+    //diagnostics throw diag_suppressed so that the work can be abandoned and redone where they are reported
+    static void suppress_on_thread() { is_suppressed = true; }
+    static void check_suppressed() {
+        if(is_suppressed) {
+            throw diag_suppressed();
+        }
+    }
+
     void print_error(size_t position);
-    void init(std::string_view new_file_name, size_t start_line, const std::vector<char>& file_content);
+    void init(std::string_view new_file_name, size_t start_line, std::string_view file_content);
 };
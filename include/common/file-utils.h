@@ -4,5 +4,31 @@
 #include <string>
 #include <optional>
 
+//Read-only contents of a file, shared by the preprocessor, the lexer and diagnostics without copying.
+//Regular files are memory mapped, anything else (pipes, devices) is read into an owned buffer.
+//Views into the contents stay valid for as long as the file_view is alive
+class file_view {
+    const char* m_data;
+    size_t m_size;
+    bool is_mapped;
+    std::string buffer;
+
+    file_view(const char* data, size_t size);
+    file_view(std::string&& contents);
+    void unmap();
+    friend std::optional<file_view> map_file(std::string_view file_name, bool exit_on_error);
+public:
+    file_view(const file_view&) = delete;
+    file_view& operator=(const file_view&) = delete;
+    file_view(file_view&& other) noexcept;
+    file_view& operator=(file_view&& other) noexcept;
+    ~file_view();
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+};
+
+std::optional<file_view> map_file(std::string_view file_name, bool exit_on_error = true);
 std::optional<std::vector<char>> read_file(std::string_view file_name, bool exit_on_error = true);
 void write_file(std::string_view name, std::string_view code);
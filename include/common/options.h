@@ -9,11 +9,15 @@ class argparser {
     int m_argc;
     char** m_argv;
     bool gen_def;
+    bool needs_input;
     std::string m_extension;
+    std::unordered_map<std::string, bool> standalone_flags; //Long options which can be used without input files
     std::string generate_default_file_name(std::string_view input_file);
 public:
     std::unordered_map<char, bool> flag_store;
     std::unordered_map<char, std::vector<std::string>> name_flag_store;
+    std::unordered_map<std::string, bool> long_flag_store;
+    std::unordered_map<std::string, std::vector<std::string>> long_name_flag_store;
 
     enum flag_type {
         NORMAL,
@@ -23,6 +27,7 @@ public:
     argparser(int argc, char** argv, std::string_view extension);
     argparser(int argc, char** argv);
     void add_flag(char ch, flag_type type);
+    void add_flag(std::string_view name, flag_type type, bool is_standalone = false);
     void parse();
     const std::vector<std::string>& get_output_files() const;
     const std::vector<std::string>& get_input_files() const;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <cstdio>
+
+//Destination of generated code. Code is handed over in pieces as soon as it is final,
+//so that a whole translation unit never has to be held in memory at once
+class output_sink {
+public:
+    virtual void write(std::string_view code) = 0;
+    virtual ~output_sink() = default;
+};
+
+//Collects everything into a string (ex: to store it in the compile cache)
+class string_sink : public output_sink {
+    std::string code;
+public:
+    void write(std::string_view new_code) override {
+        code += new_code;
+    }
+
+    std::string release() {
+        return std::move(code);
+    }
+};
+
+//Buffered writer to a file, or to an already open stream such as a pipe.
+//Files are written under a temporary name and only show up once commit() is called,
+//so a compilation that fails halfway (and exits) never leaves a partial output behind
+class file_sink : public output_sink {
+    std::FILE* stream;
+    bool owns_stream;
+    std::string name;
+    std::string tmp_name;
+    std::string buffer;
+
+    void flush_buffer(std::string_view data);
+    void close();
+public:
+    static constexpr size_t buffer_size = 1 << 16;
+
+    file_sink(std::string_view file_name);
+    file_sink(std::FILE* stream, std::string_view name);
+    file_sink(const file_sink&) = delete;
+    file_sink& operator=(const file_sink&) = delete;
+
+    void write(std::string_view code) override;
+    void flush();
+    void commit();
+    ~file_sink() override;
+};
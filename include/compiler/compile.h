@@ -1,10 +1,12 @@
 #pragma once
 
 #include "core/ast.h"
+#include "core/token-stream.h"
 #include "common/diag.h"
+#include "common/output-sink.h"
 
-void lex(const std::vector<char>& input);
-std::unique_ptr<ast> parse();
-void eval(std::unique_ptr<ast>);
-
-extern std::string asm_code;
+//Lexes all of input into tokens at once
+void lex(std::string_view input);
+void parse_init();
+std::unique_ptr<ast> parse(token_stream& stream);
+void eval(std::unique_ptr<ast>, output_sink& sink);
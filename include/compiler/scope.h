@@ -49,4 +49,5 @@ public:
     std::pair<Ifunc_translation*, scope*> add_function_definition(std::string_view fn_name, 
     const std::vector<std::string_view>& fn_args,
     const std::vector<const token*>& fn_arg_tokens);
+    void finish_function_definition(Ifunc_translation* fn);
 };
@@ -36,7 +36,7 @@ struct type_spec;
 
 struct modifier {
     std::deque<cv_info> ptr_list;
-    std::deque<std::string> array_spec;
+    std::deque<uint64_t> array_spec;
     std::vector<type_spec> fn_spec;
 
     modifier() = default;
@@ -45,7 +45,7 @@ struct modifier {
     }
 
     modifier(size_t size) {
-        array_spec.push_back(std::to_string(size));
+        array_spec.push_back(size);
     } 
 
     bool operator == (const modifier& obj) const;
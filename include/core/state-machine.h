@@ -4,6 +4,7 @@
 #include <memory>
 #include <stack>
 #include "core/token.h"
+#include "core/token-stream.h"
 #include "core/ast.h"
 #include "common/diag.h"
 
@@ -131,8 +132,8 @@ enum parser_states {
 #endif
 class state_machine {
     parser_states cur_state;
-    std::vector<token>* token_stream;
-    size_t token_idx;
+    token_stream* stream;
+    token* last_token;
     size_t num_states;
 
     bool advance_token;
@@ -156,23 +157,13 @@ class state_machine {
     };
 
     std::vector<_state> state_path;
-#ifdef MODSIME
-    diag* diag_inst;
-    size_t dir_pos;
-#endif
 public:
-#ifdef MODSIME
-    bool parse_success;
-#endif
     std::stack<std::unique_ptr<ast>> parser_stack;
     std::stack<parser_states> state_stack;
     
     state_machine();
     
-    void set_token_stream(std::vector<token>&);
-#ifdef MODSIME
-    void set_diag_inst(diag* inst, size_t dir_start_pos); 
-#endif
+    void set_token_stream(token_stream&);
 
     token* fetch_token(); 
     std::unique_ptr<ast> fetch_parser_stack(); 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include "core/token.h"
+
+class lexer;
+
+//Tokens of a source, lexed as the parser asks for them. The lexer is never more than a token ahead of the parser
+//(it holds one back to join "else if", "long long" and adjacent strings), unless it runs on a thread of its own.
+//Tokens which were handed out stay where they are until the stream is destroyed, as the AST points at them.
+//Large sources are lexed ahead on another thread, which hands tokens over through a single producer single consumer ring.
+//Lexical errors are reported once the parser gets to them in either case, or before any error of the parser
+class token_stream {
+    std::unique_ptr<lexer> source_lexer;
+    std::deque<token> store;
+    size_t next_idx = 0;
+
+    //Lexer thread
+    std::vector<token> ring;
+    alignas(64) std::atomic<size_t> ring_head = 0;  // Next token the parser takes
+    alignas(64) std::atomic<size_t> ring_tail = 0;  // Next slot the lexer fills
+    std::atomic<bool> is_lexed = false;
+    std::atomic<bool> is_stopped = false;
+    std::thread lexer_thread;
+
+    bool pull();
+
+public:
+    explicit token_stream(std::string_view source);
+    ~token_stream();
+
+    static token_stream* current;   // Stream the parser reads, if any
+
+    bool is_end();
+    token* fetch();
+    void lex_to_end();
+};
@@ -1,7 +1,8 @@
 #pragma once
 #include <vector>
 #include <string>
-#include <variant>
+#include <deque>
+#include <cstdint>
 #include "common/diag.h"
 #include "debug-api.h"
 
@@ -80,50 +81,33 @@ enum operator_type {
     SEMICOLON
 };
 
-#ifdef MODSIMCC
-extern size_t global_token_pos;
-#endif
-
+//Tokens are 16 bytes and don't own any text. Identifiers, integer constants and string constants refer to
+//the tables below, which the lexer fills for the unit being compiled
 struct token {
 private:
-    token_type type;
-    token_sub_type sub_type;
-#ifdef MODSIMCC
-    size_t position;
-#endif
+    uint8_t type;           // token_type
+    uint8_t sub_type;       // token_sub_type of constants
+    uint32_t position;      // Index into the source that diagnostics point at. Identifiers and integer constants end here
+    uint32_t length;        // Of identifiers and integer constants
+    uint32_t data;          // Character, operator_type, keyword_type, name id, or index into the constant tables
     bool is_keyword_data_type() const;
+    friend class lexer;     // Moves the tokens of a chunk to the tables of the whole source
 
 public:
 #ifdef MODSIMCC
     static diag global_diag_inst;   
 #endif
-    std::variant<char, std::string, operator_type, keyword_type> value;
-    
-    template<typename T>
-    token(token_type _type, const T& val) : type(_type) {
-        value = val;
-#ifdef MODSIMCC
-        position = global_token_pos - 1;
-#endif
-    }
 
-    token(token_type _type, token_sub_type _sub_type, const std::string& num) {
-        type = CONSTANT;
-        sub_type = _sub_type;
-        value = num;
-#ifdef MODSIMCC
-        position = global_token_pos - 1;
-#endif
-    }
+    token(token_type _type, uint32_t _data, size_t _position, token_sub_type _sub_type = TOK_INT, size_t _length = 0) : 
+    type(_type), sub_type(_sub_type), position(_position), length(_length), data(_data) {}
 
-    token(token_type _type, const char& val) {
-        type = CONSTANT;
-        sub_type = TOK_CHAR;
-        value = val;
-#ifdef MODSIMCC
-        position = global_token_pos - 1;
-#endif
-    }
+    keyword_type get_keyword() const;
+    operator_type get_operator() const;
+    char get_char() const;
+    uint64_t get_int_value() const;
+    //Name of an identifier, spelling of an integer constant or contents of a string constant
+    std::string_view get_text() const;
+    void set_keyword(keyword_type keyword);
 
     bool is_keyword_else() const;
     bool is_keyword_return() const;
@@ -173,24 +157,21 @@ public:
 #ifdef SIMDEBUG
     void print() const;
 #endif
+};
 
-#ifdef MODSIME
-    bool pre_transform() {
-        if(!((type == CONSTANT && (sub_type == TOK_INT || sub_type == TOK_CHAR)) || type == OPERATOR)) {
-            sim_log_debug("Stopping further evaluation as invalid token type detected");
-            return true;    
-        }
+static_assert(sizeof(token) <= 16, "token should stay within 16 bytes");
 
-        if(type == CONSTANT && sub_type == TOK_CHAR) {
-            sub_type = TOK_INT;
-            value = std::to_string(std::get<char>(value));
-        }
-        return false;
-    }
-#endif
+//Text and values the tokens of a unit refer to
+struct token_tables {
+    std::string_view source;
+    std::vector<std::string_view> names;        // Interned identifiers, indexed by name id
+    std::vector<std::string_view> strings;      // String constants, adjacent ones joined
+    std::deque<std::string> joined_strings;     // Storage of the joined string constants
+    std::vector<uint64_t> integers;             // Values of integer constants
 };
 
 extern std::vector<token> tokens;
+extern token_tables* token_data;    // Of the source being compiled
 
 #ifdef SIMDEBUG
 extern std::vector<std::string> keywords_debug;
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <filesystem>
+
+//On-disk cache of compiler output, enabled by setting SIMC_CACHE_DIR.
+//Entries are addressed by a hash of the preprocessed text, the compiler identity and the flags
+//affecting code generation, so any change in a header or a macro definition is a miss.
+//The cache is shared by concurrent simc processes: entries are written to a temporary file and
+//renamed into place, and the statistics are updated under a file lock
+class compile_cache {
+public:
+    struct statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t bytes_saved = 0;
+        uint64_t size = 0;
+    };
+
+private:
+    std::filesystem::path root;
+    uint64_t max_size;
+
+    std::filesystem::path entry_path(const std::string& key) const;
+    void update_stats(uint64_t hits, uint64_t misses, uint64_t bytes_saved, int64_t size_delta);
+    uint64_t evict(uint64_t target_size);
+
+public:
+    //Defaults to 1G, SIMC_CACHE_SIZE accepts a byte count with an optional K, M or G suffix
+    static constexpr uint64_t default_max_size = 1ull << 30;
+
+    //Returns nothing if SIMC_CACHE_DIR is not set
+    static std::optional<compile_cache> from_environment();
+
+    compile_cache(std::filesystem::path root, uint64_t max_size);
+
+    std::string make_key(std::string_view preprocessed, std::string_view flags) const;
+    std::optional<std::string> lookup(const std::string& key);
+    void store(const std::string& key, std::string_view code);
+
+    statistics fetch_stats();
+    const std::filesystem::path& directory() const { return root; }
+    uint64_t capacity() const { return max_size; }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "lib/dll.h"
+#include "common/output-sink.h"
+
+#ifdef SIMDEBUG
+#include <memory>
+#include "spdlog/spdlog.h"
+#endif
+
+//In-process entry points for the preprocessor and the compiler.
+//Both are built into separate shared libraries (with hidden visibility) so that
+//their symbols never clash
+
+//The standalone sime and simcc executables compile these entry points in directly
+#if defined(MODSIMC) || defined(MODBENCH) || defined(BUILD_LIB)
+    #define PIPELINE_ATTRIB DLL_ATTRIB
+#else
+    #define PIPELINE_ATTRIB
+#endif
+
+//Preprocesses given file and returns the preprocessed text.
+//When pch_file is given, the file is preprocessed on top of the state saved in the precompiled header.
+//Translation units share nothing but the include cache, so several can be preprocessed on different threads.
+//With max_jobs above 1, the top level includes of the file are preprocessed ahead of time on up to max_jobs-1 threads
+PIPELINE_ATTRIB std::string preprocess_unit(std::string_view file_name, const std::vector<std::string>& search_dirs,
+    std::string_view pch_file = std::string_view(), size_t max_jobs = 1);
+//Records expansions of every macro and inclusions of every file (count, bytes produced and time spent)
+//for the translation units preprocessed after it's called
+PIPELINE_ATTRIB void enable_macro_profile();
+//Report of everything recorded so far, sorted by time spent
+PIPELINE_ATTRIB std::string fetch_macro_profile(bool is_json);
+//Preprocesses a header and saves the resulting macros, include state and output into pch_file
+PIPELINE_ATTRIB void emit_pch(std::string_view header_name, const std::vector<std::string>& search_dirs, std::string_view pch_file);
+
+//Compiles preprocessed text, every function is written into sink as soon as it is generated
+PIPELINE_ATTRIB void compile_unit(std::string_view file_name, std::string_view source, output_sink& sink);
+PIPELINE_ATTRIB void compile_unit(std::string_view file_name, std::string_view source, std::string_view output_file);
+//Returns the generated assembly instead (ex: to store it in the compile cache)
+PIPELINE_ATTRIB std::string compile_unit(std::string_view file_name, std::string_view source);
+
+//Builds compiler state which is reused by every compilation (ex: parser state tables)
+PIPELINE_ATTRIB void init_compiler();
+
+#ifdef SIMDEBUG
+PIPELINE_ATTRIB void init_preprocessor_debugger(std::shared_ptr<spdlog::logger>& logger);
+PIPELINE_ATTRIB void init_compiler_debugger(std::shared_ptr<spdlog::logger>& logger);
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+//Runs a list of independent jobs with at most max_jobs of them running at once.
+//Every job runs in its own forked worker, since the preprocessor and compiler keep global state
+//and terminate the process on error. With max_jobs = 1 the jobs run serially within this process
+class job_scheduler {
+    size_t max_jobs;
+    std::vector<std::function<int()>> jobs;
+
+    bool run_serial();
+    bool run_parallel();
+public:
+    job_scheduler(size_t max_jobs);
+    void add_job(std::function<int()> job);
+    bool run() &&;
+};
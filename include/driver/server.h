@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+
+struct compile_request {
+    std::vector<std::string> args;
+    std::string cwd;
+    std::vector<std::string> env;
+};
+
+struct compile_response {
+    int exit_code;
+    std::string diagnostics;
+    std::vector<std::string> output_files;
+};
+
+//Keeps a warm simc process alive on a local unix socket.
+//Every request is served by a fork of the server, so it starts out with the libraries loaded and
+//the compiler state tables built, while a failing compilation can't take the server down
+class compile_server {
+public:
+    using driver_fn = int (*)(int argc, char** argv);
+    using outputs_fn = std::vector<std::string> (*)(int argc, char** argv);
+
+private:
+    std::string socket_path;
+    driver_fn driver;
+    outputs_fn outputs;
+
+    void handle_connection(int conn);
+    compile_response run_request(const compile_request& request);
+
+public:
+    //SIMC_SERVER_SOCKET overrides the default location
+    static std::string default_socket_path();
+
+    compile_server(std::string_view socket_path, driver_fn driver, outputs_fn outputs);
+    int serve();
+};
+
+//Captures the arguments, working directory and environment of the current process
+compile_request make_compile_request(int argc, char** argv);
+
+//Thin client side. Returns nothing if no server is listening on the socket
+std::optional<compile_response> forward_to_server(std::string_view socket_path, const compile_request& request);
@@ -33,7 +33,7 @@ static inline void init_logger() {
     const std::string log_file = fmt::format("{}/{}/{}", LOG_DIR, MODULENAME, log_file_name);
 
     std::vector<spdlog::sink_ptr> sinks;
-    sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_st>());
+    sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_mt>()); //sime logs from several threads with -j
     sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file, true));
 
     auto logger = std::make_shared<spdlog::logger>(LOGGER, std::begin(sinks), std::end(sinks));
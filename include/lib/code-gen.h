@@ -5,6 +5,7 @@
 #include <variant>
 #include "spdlog/fmt/fmt.h"
 #include "lib/dll.h"
+#include "common/output-sink.h"
 
 #ifdef ARCH_X64
 #include "lib/x64/x64_types.h"
@@ -67,6 +68,10 @@ public:
     std::string fetch_code() {
         return code;
     }
+
+    std::string release_code() {
+        return std::move(code);
+    }
 };
 
 class Ifunc_translation : public Itrbase {
@@ -170,9 +175,14 @@ public:
     virtual void init_variable(int var_id, std::string_view constant) = 0;
     virtual int declare_global_mem_variable(std::string_view name, bool is_static, size_t mem_var_size) = 0; 
     virtual int declare_string_constant(std::string_view name, std::string_view value) = 0;
+
+    //Writes out a function whose body is complete, nothing can be added to it afterwards
+    virtual void finish_function(Ifunc_translation* fn) = 0;
+    //Writes out the remaining functions and the global data
     virtual void generate_code() = 0;
 
     virtual ~Itranslation() = default;
 };
 
-DLL_ATTRIB Itranslation* create_translation_unit(); 
+//Generated code is written into sink as it becomes final
+DLL_ATTRIB Itranslation* create_translation_unit(output_sink* sink); 
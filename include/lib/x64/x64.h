@@ -43,9 +43,17 @@ void filter_type(c_type& type, bool& is_signed);
 void filter_type(c_type& type);
 
 class x64_tu : public Itranslation {
+    struct fn_info {
+        x64_func* fn;
+        size_t var;
+        bool is_written;
+    };
+
     std::vector<c_var> globals;
-    std::vector<std::pair<x64_func*, size_t>> fn_list;
+    std::vector<fn_info> fn_list;
     size_t global_var_id;
+    output_sink* sink;
+    bool text_section_started;
 
 
     enum Segment {
@@ -67,21 +75,24 @@ class x64_tu : public Itranslation {
             else if constexpr (segment == RODATA) {
                 seg_name = LINE(".section .rodata");
             }
-            data = seg_name + data;
-            add_inst_to_code(data);
-            add_inst_to_code(LINE());
+            sink->write(seg_name);
+            sink->write(data);
+            sink->write(LINE());
         }
     }
 
+    void write_function(fn_info& info);
+
 public:
     
-    x64_tu();
+    x64_tu(output_sink* sink);
     
     int declare_global_variable(std::string_view name, c_type type, bool is_signed, bool is_static) override;
     void init_variable(int var_id, std::string_view constant) override;
     int declare_global_mem_variable(std::string_view name, bool is_static, size_t mem_var_size) override; 
     int declare_string_constant(std::string_view name, std::string_view value) override;
     Ifunc_translation* add_function(std::string_view name, c_type ret_type, bool is_signed, bool is_static) override; 
+    void finish_function(Ifunc_translation* fn) override;
     void generate_code() override;
 
     const c_var& fetch_global_variable(int id) const;
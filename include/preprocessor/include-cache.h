@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include "common/file-utils.h"
+
+//Files read by the preprocessor, kept for the lifetime of the process so that a header included
+//from many places (or by many input files) is read only once.
+//Translation units preprocessed on different threads share it, entries never change once fetched
+//except for the include guard, which is set at most once
+class include_cache {
+public:
+    struct entry {
+        std::string path; //Canonical path
+        file_view contents;
+
+    private:
+        std::string guard_macro;
+        std::atomic<bool> has_guard = false;
+        std::once_flag guard_set;
+
+    public:
+        entry(std::string path, file_view contents) : path(std::move(path)), contents(std::move(contents)) {}
+
+        //Empty unless the whole file is known to be wrapped in #ifndef guard()
+        std::string_view guard() const { return has_guard.load(std::memory_order_acquire) ? std::string_view(guard_macro) : std::string_view(); }
+        void set_guard(std::string_view macro);
+    };
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<entry>> files; //Keyed by canonical path
+    std::unordered_map<std::string, entry*> paths; //Keyed by the path as asked for, nullptr if there is no such file
+    std::mutex files_lock;
+    std::atomic<size_t> hits = 0;
+    std::atomic<size_t> misses = 0;
+    std::atomic<size_t> saved_probes = 0;
+
+public:
+    //Returns nullptr if the file can't be read. A path is only looked for on disk the first time it's asked for,
+    //so a missing file stays missing for the rest of the process
+    entry* fetch(std::string_view path);
+
+    size_t hit_count() const { return hits; }
+    size_t miss_count() const { return misses; }
+    //Lookups answered without going to the file system
+    size_t saved_probe_count() const { return saved_probes; }
+    void add_saved_probes(size_t probes) { saved_probes += probes; }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+//Output of a preprocessor instance.
+//Expanded tokens are inserted where the token started (prev_token_pos), usually just before a little
+//whitespace that was read after it. The text is kept in two parts split at the last insert position:
+//inserting there is an append to the head, and anything written after it goes to the tail.
+//Both parts are joined only when a contiguous view is asked for
+class output_buffer {
+    std::string head;
+    std::string tail;
+
+    void move_split(size_t pos);
+public:
+    void append(std::string_view text);
+    void append(char ch);
+    void insert(size_t pos, std::string_view text);
+    //Removes everything from pos to the end
+    void truncate(size_t pos);
+
+    size_t size() const { return head.size() + tail.size(); }
+    bool empty() const { return !size(); }
+    char back() const { return tail.size() ? tail.back() : head.back(); }
+
+    std::string_view view();
+    std::string release();
+
+    output_buffer& operator+=(std::string_view text) { append(text); return *this; }
+    output_buffer& operator+=(char ch) { append(ch); return *this; }
+};
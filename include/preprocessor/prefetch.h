@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+#include "preprocessor/include-cache.h"
+
+//Reads the headers of a file on background threads, ahead of the preprocessor getting to its #include lines.
+//Headers are looked for the way handle_include does and loaded into the include cache, so handle_include finds them
+//(or finds them missing) without waiting on the disk. Headers of the loaded headers are prefetched as well.
+//#include lines within conditional blocks are prefetched too, reading a header which isn't used only costs I/O
+class include_prefetcher {
+    struct task {
+        const include_cache::entry* file;
+        std::string file_dir;   // Directory of the file as it was named when included
+        std::shared_ptr<const std::vector<std::string>> search_dirs;
+    };
+
+    include_cache& cache;
+    size_t max_threads;
+    std::deque<task> tasks;
+    std::unordered_set<const include_cache::entry*> scanned;
+    std::shared_ptr<const std::vector<std::string>> last_search_dirs;
+    bool is_stopped = false;
+    std::mutex lock;
+    std::condition_variable has_task;
+    std::vector<std::thread> workers;   // Started with the first file, a process which doesn't preprocess has none
+
+    void scan(const task& work);
+    void add_task(const include_cache::entry* file, std::string file_dir, std::shared_ptr<const std::vector<std::string>> search_dirs);
+
+public:
+    include_prefetcher(include_cache& cache, size_t max_threads);
+    ~include_prefetcher();
+
+    //file_name is the name the file was opened (or included) with
+    void prefetch(const include_cache::entry* file, std::string_view file_name, const std::vector<std::string>& search_dirs);
+};
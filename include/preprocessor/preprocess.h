@@ -3,7 +3,15 @@
 #include <string>
 #include <vector>
 #include <stack>
+#include <memory>
+#include <span>
+#include <unordered_set>
+#include <unordered_map>
 #include "preprocessor/sym_table.h"
+#include "preprocessor/include-cache.h"
+#include "preprocessor/prefetch.h"
+#include "preprocessor/output-buffer.h"
+#include "preprocessor/profile.h"
 #include "common/diag.h"
 
 enum parser_state {
@@ -14,6 +22,33 @@ enum parser_state {
 };
 
 
+class include_speculation;
+
+//State of a single translation unit. Every preprocess instance working on the unit refers to it,
+//so translation units preprocessed on different threads share nothing but the include cache
+struct unit_context {
+    sym_table table;
+    std::vector<sym_table::atom> expansions; //Macros being expanded, innermost last (self recursion is stopped by the table)
+    std::vector<std::string> ancestors; //Construct to prevent infinite recursion during file inclusion 
+    std::unordered_set<const include_cache::entry*> once_files; //Files with #pragma once seen in this translation unit
+    std::vector<const include_cache::entry*> included_files; //Every file preprocessed for this translation unit
+    std::unordered_map<std::string, std::pair<uint64_t, bool>> if_cache; //#if results, valid while the table generation matches
+    std::vector<std::string> search_directories;
+    struct include_resolution {
+        include_cache::entry* file = nullptr;
+        std::string path;
+        size_t probes = 0;  // Files looked for until it was found
+    };
+    //Keyed on the directory of the including file, the delimiter and the spelled path. Entries are never removed
+    std::unordered_map<std::string, include_resolution> include_resolutions;
+    std::unique_ptr<expansion_profile> profile; //Only set when the unit is profiled (-fmacro-profile)
+    size_t speculative_jobs = 1; //Threads the top level includes may be preprocessed on
+    std::unique_ptr<include_speculation> speculation;
+
+    unit_context(const std::string& top_file_name, const std::vector<std::string>& search_dirs);
+    ~unit_context();
+};
+
 //Preprocessor parsing and state handling construct
 class preprocess {
 
@@ -38,9 +73,18 @@ class preprocess {
         size_t offset;
     };
 
-    const std::vector<char>& contents;
-    std::string output;
-    std::string file_name;
+    //Multiple include optimization. A file whose only content is an #ifndef/#endif pair
+    //is skipped on later includes while the guard macro is defined
+    enum guard_state {
+        GUARD_START,    // No directive seen yet
+        GUARD_OPEN,     // Inside the #ifndef that may be the guard
+        GUARD_CLOSED,   // Guard closed, only whitespace may follow
+        GUARD_NONE      // Not a guarded file (or not a file at all)
+    };
+
+    std::string_view contents;
+    output_buffer output;
+    std::string_view file_name;  // Owned by whoever started the file, which outlives every instance working on it
     diag diag_inst;  // Gives us file diagnostic information (Helpful while printing diagnostic messages)
     struct preprocess_context {
         bool handle_directives;     // Turned on when handling top level file
@@ -60,8 +104,9 @@ class preprocess {
         bool consider_angle_as_str;
         bool process_defined_token; // Tells if preprocessor should process the "defined()" operator
         bool passive_scan;
-        std::vector<std::string> set_actual_args;
-        std::vector<std::string> macro_args;
+        //Borrowed from the instance which read the arguments and from the macro table, both outlive the expansion
+        std::span<const std::string> set_actual_args;
+        std::span<const std::string> macro_args;
     
         void copy_macro_params(const preprocess_context& new_context) {
             in_macro_expansion = new_context.in_macro_expansion;
@@ -79,10 +124,12 @@ class preprocess {
     size_t string_op_pos;
     size_t bracket_count;
     parser_state state;
-    std::stack<ifdef_info> ifdef_stack; 
-    static sym_table table;
-    static std::vector<std::string> parents; //Construct to prevent infinite recursion during macro expansion
-    static std::vector<std::string> ancestors; //Construct to prevent infinite recursion during file inclusion 
+    std::stack<ifdef_info, std::vector<ifdef_info>> ifdef_stack; //Unlike a deque, an empty vector doesn't allocate
+    include_cache::entry* file_entry;
+    guard_state guard;
+    std::string guard_macro;
+    size_t guard_end;
+    unit_context& unit;
     
     void handle_line_comment();
     void handle_block_comment();
@@ -93,17 +140,24 @@ class preprocess {
     void handle_define(std::string_view dir_line);
     void handle_undef(std::string_view dir_line);
     void handle_ifdef(std::string_view expression, std::string_view directive); 
+    void skip_inactive_lines();
+    void handle_pragma(std::string_view dir_line);
+    void track_include_guard(std::string_view directive, std::string_view expression);
+    void record_include_guard();
+    bool is_include_skipped(const include_cache::entry* entry);
 	void setup_prev_token_macro(const std::string& new_token); 
     void place_barrier();
     std::tuple<bool, std::vector<std::string>, std::string_view, bool> parse_macro_args(std::string_view macro_line);
     std::string process_token(std::string_view cur_token);
-    std::string expand_token(std::string_view cur_token);
+    std::string_view expand_token(std::string_view cur_token);
     std::string expand_variadic_args();
     std::string stringify_token(std::string_view token);
     void insert_token_at_pos(size_t pos, std::string_view token); 
     std::string macro_arg_expand(std::string_view token);
     void print_error(size_t pos);
     bool is_word_parent(std::string_view word);
+    void begin_expansion(std::string_view macro);
+    void end_expansion();
     bool is_function_macro(std::string_view token);
     bool is_macro_arg(std::string_view token);
     bool is_end_of_line(bool do_skip = true);
@@ -112,7 +166,7 @@ class preprocess {
     bool is_alpha_num();
     bool is_valid_macro(std::string_view ident);
     bool is_valid_ident(std::string_view ident);
-    std::string trim_whitespace(const std::string& token);
+    std::string_view trim_whitespace(std::string_view token);
     endline_marker figure_new_line();
     std::string fetch_end_line_marker();
     std::pair<std::string, size_t> read_next_token(std::string_view line);
@@ -122,12 +176,21 @@ class preprocess {
     bool is_alpha_numeric_token(std::string_view token);
     void config_diag(const preprocess* inst);
 public:
-    static std::vector<std::string> search_directories; 
-   
-    static void init_with_defaults(const std::string& top_file_name);
-    preprocess(const std::vector<char>& input, bool handle_directives = true, 
+    //Shared by every translation unit of the process
+    static include_cache file_cache;
+    static include_prefetcher prefetcher;
+
+    //Precompiled headers. The macro table, include guards, #pragma once files, dependencies and
+    //the output of a preprocessed header are saved, so that a translation unit can start from them
+    static void write_pch(const unit_context& unit, std::string_view pch_file, std::string_view header_output);
+    static std::string read_pch(unit_context& unit, std::string_view pch_file);
+
+    preprocess(unit_context& unit, std::string_view input, bool handle_directives = true, 
     bool read_single_line = false, bool read_macro_arg = false);
     void parse();
     void init_diag(std::string_view name, size_t line_num = 1);
-    std::string_view get_output() const;
+    //For instances preprocessing a whole file, called after init_diag(). Starts prefetching the headers of the file
+    void set_file_entry(include_cache::entry* entry);
+    std::string_view get_output();
+    std::string release_output();
 };
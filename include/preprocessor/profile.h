@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+//Where preprocessing time goes, per macro and per included file (sime -fmacro-profile).
+//Every translation unit records into a profile of its own, which is merged into the process wide one when the unit is done
+class expansion_profile {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct entry {
+        size_t count = 0;           // Expansions of the macro (or inclusions of the file)
+        size_t bytes = 0;           // Output produced
+        size_t max_depth = 0;       // Deepest expansion nesting the macro was seen at (1 is not nested)
+        clock::duration time{};     // Includes nested expansions and inclusions
+    };
+
+private:
+    std::unordered_map<std::string, entry> macros;
+    std::unordered_map<std::string, entry> files;
+    std::mutex merge_lock;
+
+public:
+    void record_macro(std::string_view name, size_t bytes, size_t depth, clock::duration time);
+    void record_file(std::string_view name, size_t bytes, clock::duration time);
+    void merge(const expansion_profile& unit_profile);
+
+    //Tables sorted by time, slowest first
+    std::string report() const;
+    std::string json_report() const;
+};
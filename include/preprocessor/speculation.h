@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+#include "preprocessor/include-cache.h"
+
+struct unit_context;
+
+//Top level #includes of the input file, preprocessed ahead of time on other threads (sime -j).
+//Every header starts out from the state of the unit at the first top level #include and records the macros
+//it looked up and changed. Its output is used only if none of those macros were changed in the meantime,
+//otherwise the header is preprocessed again when the input file gets to it
+class include_speculation {
+    struct header {
+        size_t directive_idx;        // Offset of the '#' of the #include in the input file
+        std::string_view directive;
+        std::unique_ptr<unit_context> unit;
+        std::unordered_set<std::string> reads;
+        std::unordered_set<std::string> writes;
+        std::string output;
+        bool is_started = false;
+        bool is_done = false;
+        bool is_failed = false;     // Ran into a diagnostic, which is reported when the header is preprocessed again
+    };
+
+    unit_context& unit;
+    std::string file_name;
+    std::vector<header> headers;                                    // In the order of the input file
+    std::unordered_set<const include_cache::entry*> once_files;     // #pragma once files of the unit at the start
+    std::unordered_set<std::string> written;                        // Macros the unit changed since the start
+    size_t next_header = 0;
+    bool is_cancelled = false;
+    std::mutex lock;
+    std::condition_variable done;
+    std::vector<std::thread> workers;
+
+    void run(header& spec);
+    bool is_valid(const header& spec, const include_cache::entry* entry);
+
+public:
+    //Headers included after start_idx of the input file are handed to up to max_jobs-1 threads
+    include_speculation(unit_context& unit, std::string_view contents, size_t start_idx, std::string_view file_name, size_t max_jobs);
+    ~include_speculation();
+
+    //Returns the output of the #include at directive_idx and updates the unit as if the header was preprocessed,
+    //if the header was speculated and is still valid
+    std::optional<std::string> commit(size_t directive_idx, const include_cache::entry* entry);
+};
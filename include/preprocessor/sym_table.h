@@ -1,11 +1,16 @@
 #pragma once
 
 #include <string>
-#include <optional>
-#include <unordered_map>
+#include <string_view>
+#include <cstdint>
+#include <deque>
 #include <vector>
+#include <unordered_set>
 
+//Identifiers are interned once into atoms, which index the macro information directly.
+//Lookups hash the identifier once and never allocate, names of atoms live as long as the table
 struct sym_table {
+    using atom = uint32_t;
 
     struct sym_info {
         bool has_value;
@@ -13,14 +18,67 @@ struct sym_table {
         bool is_variadic;
         std::vector<std::string> args;
     };
-    std::unordered_map<std::string, sym_info> values;
+
+private:
+    struct atom_entry {
+        std::string name;
+        size_t hash;
+        bool is_defined;
+        uint32_t expanding;     // Depth of expansions of this macro that are in progress
+        sym_info info;
+    };
+
+    static constexpr uint32_t empty_slot = UINT32_MAX;
+
+    std::deque<atom_entry> atoms;   // Entries never move, so references to them stay valid
+    std::vector<uint32_t> slots;    // Open addressing with linear probing, power of two sized
+    size_t defined_count = 0;
+    uint64_t m_generation = 0;      // Changes whenever a macro is defined or undefined
+    std::unordered_set<std::string>* read_log = nullptr;
+    std::unordered_set<std::string>* write_log = nullptr;
+
+    void grow();
+    uint32_t probe(std::string_view name, size_t hash) const;
+    atom_entry& fetch_defined(std::string_view name);
+
 public:
-    void add_symbol(std::string name, bool has_value = false, bool is_macro = false, 
+    sym_table();
+
+    atom intern(std::string_view name);
+    //Doesn't intern, so looking up ordinary identifiers doesn't grow the table
+    const sym_info* find(std::string_view name) const;
+    std::string_view name(atom id) const { return atoms[id].name; }
+
+    void add_symbol(std::string_view name, bool has_value = false, bool is_macro = false,
     bool is_variadic = false, std::string value = "");
-    void add_macro_args(const std::string& name, std::vector<std::string>& args);
-    void remove_symbol(const std::string& name);
-    std::pair<bool, bool> has_symbol(const std::string& name);
-    std::string& operator [](const std::string& name);
-    std::vector<std::string>& fetch_macro_args(const std::string& name); 
-    std::pair<bool, bool> is_macro(const std::string& name);
+    void add_symbol(std::string_view name, sym_info info);
+    void add_macro_args(std::string_view name, std::vector<std::string>& args);
+    void remove_symbol(std::string_view name);
+    std::pair<bool, bool> has_symbol(std::string_view name) const;
+    std::string& operator [](std::string_view name);
+    std::vector<std::string>& fetch_macro_args(std::string_view name);
+    std::pair<bool, bool> is_macro(std::string_view name);
+
+    //Macros being expanded are not expanded again within their own expansion
+    void begin_expansion(atom id);
+    void end_expansion(atom id);
+    bool is_expanding(std::string_view name) const;
+
+    //Names looked up (defined or not) and names defined or undefined are added to the logs, while they are set
+    void track_access(std::unordered_set<std::string>* reads, std::unordered_set<std::string>* writes) {
+        read_log = reads;
+        write_log = writes;
+    }
+
+    size_t size() const { return defined_count; }
+    uint64_t generation() const { return m_generation; }
+
+    template<typename Fn>
+    void for_each_symbol(Fn fn) const {
+        for(const auto& entry: atoms) {
+            if(entry.is_defined) {
+                fn(std::string_view(entry.name), entry.info);
+            }
+        }
+    }
 };
@@ -14,7 +14,7 @@ void filter_type(c_type& type) {
     }
 }
 
-x64_tu::x64_tu() : global_var_id(0) {
+x64_tu::x64_tu(output_sink* sink) : global_var_id(0), sink(sink), text_section_started(false) {
     x64_func::new_label_id = 0;
     x64_func::static_id = 0;
 }
@@ -77,14 +77,50 @@ Ifunc_translation* x64_tu::add_function(std::string_view name, c_type ret_type,
 
     declare_global_variable(name, ret_type, is_signed, is_static);
     globals[global_var_id-1].is_fn = true;
-    fn_list.push_back({fn, global_var_id - 1});
+    fn_list.push_back({fn, global_var_id - 1, false});
 
     return fn;
 }
 
+void x64_tu::write_function(fn_info& info) {
+    if(info.is_written) {
+        return;
+    }
+
+    if(!text_section_started) {
+        sink->write(LINE(".section .text"));
+        text_section_started = true;
+    }
+
+    info.fn->generate_code();
+    if(!globals[info.var].is_static) {
+        std::string_view name = info.fn->fetch_fn_name();
+        sink->write(fmt::format(LINE(".global {}"), name));
+        sink->write(fmt::format(LINE(".type {}, @function"), name));
+    }
+    sink->write(info.fn->release_code());
+    sink->write(LINE());
+    info.is_written = true;
+}
+
+void x64_tu::finish_function(Ifunc_translation* fn) {
+    auto info = std::find_if(fn_list.rbegin(), fn_list.rend(), [fn](const fn_info& info) {
+        return info.fn == fn;
+    });
+    CRITICAL_ASSERT(info != fn_list.rend(), "finish_function() called with a function not in this translation unit");
+
+    sim_log_debug("Writing out function:{}", info->fn->fetch_fn_name());
+    write_function(*info);
+}
+
 void x64_tu::generate_code() {
     static const char* global_type_names[] = {"byte", "word", "long", "quad", "quad"};
     
+    //Functions are written first, as static variables and string constants are only known once every body is done
+    for(auto& info : fn_list) {
+        write_function(info);
+    }
+
     std::string bss_section;
     std::string data_section;
     std::string rodata_section;
@@ -116,31 +152,17 @@ void x64_tu::generate_code() {
     write_segment<DATA>(data_section);
     write_segment<BSS>(bss_section);
     write_segment<RODATA>(rodata_section);
-
-    if(fn_list.size()) {
-        add_inst_to_code(LINE(".section .text"));
-    }
-    for(auto& [fn, var] : fn_list) {
-        fn->generate_code();
-        if(!globals[var].is_static) {
-            std::string_view name = fn->fetch_fn_name();
-            add_inst_to_code(fmt::format(LINE(".global {}"), name));
-            add_inst_to_code(fmt::format(LINE(".type {}, @function"), name));
-        }
-        add_inst_to_code(fn->fetch_code());
-        add_inst_to_code(LINE());
-    }
 }
 
-Itranslation* create_translation_unit() {
-    auto unit = new x64_tu();
+Itranslation* create_translation_unit(output_sink* sink) {
+    auto unit = new x64_tu(sink);
 
     return unit;
 }
 
 x64_tu::~x64_tu() {
-    for(auto [fn, size]: fn_list) {
+    for(auto& info: fn_list) {
         sim_log_debug("Deleting function instances");
-        delete fn;
+        delete info.fn;
     }
 }